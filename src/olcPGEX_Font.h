@@ -12,7 +12,9 @@
 	support for using TTF fonts as well as your own custom spritemap.
 
 	It expects you to have FreeType installed and configured properly
-	in your project.
+	in your project, unless OLC_PGEX_FONT_NO_FREETYPE is defined, in
+	which case only fonts embedded with tools/olcFontEmbed.cpp are
+	available.
 
 	For more information visit: https://www.freetype.org/
 
@@ -64,18 +66,48 @@
 
 	olc::bbox string_size = font->MeasureString("Hello World");
 
+	// Font generated ahead of time with tools/olcFontEmbed, no FreeType or file I/O
+	#include "roboto12.h"
+
+	static_assert(olc::embedded::roboto12.Has('A'));
+	font = new olc::EmbeddedFont(olc::embedded::roboto12);
+	font->BuildSprite();
+
+	// Text that changes every frame only re-lays out from the first changed character
+	auto score = new olc::DynamicText(font, 32);
+	score->Set("Score: " + std::to_string(points));
+	score->Draw(this, { 16, 64 });
+
+	// Software rendering straight into a sprite, no window required
+	font = new olc::TTFFont("./Assets/Fonts/Roboto-Medium.ttf", 12);
+	font->BuildSprite(false);
+
+	auto image = new olc::Sprite(256, 64);
+	font->DrawString(image, { 16, 16 }, "Hello World", olc::RED);
+
 */
 
 
 #pragma once
 
 #include <cstdarg>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
 #include <iostream>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OLC_PGEX_FONT_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifndef OLC_PGEX_FONT_NO_FREETYPE
 #define FT_CONFIG_OPTION_SUBPIXEL_RENDERING
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#endif
 
 namespace olc
 {
@@ -88,6 +120,67 @@ namespace olc
 		T w;
 	};
 
+	// Glyph metrics and atlas placement of a font embedded by tools/olcFontEmbed
+	struct EmbeddedGlyph
+	{
+		uint32_t codepoint;
+		int horizontalBearingX;
+		int horizontalBearingY;
+		int horizontalAdvance;
+		int verticalBearingX;
+		int verticalBearingY;
+		int verticalAdvance;
+		int atlasX;
+		int atlasY;
+		int width;
+		int height;
+	};
+
+	struct EmbeddedFontData
+	{
+		int atlasWidth;
+		int atlasHeight;
+		int lineHeight;
+		int glyphCount;
+		const EmbeddedGlyph* glyphs; // Sorted by codepoint
+		const int16_t* ascii;        // 128 glyph indices, -1 when missing
+		const uint8_t* atlas;        // atlasWidth * atlasHeight coverage values
+
+		// Index into glyphs, or -1 when the font does not contain codepoint
+		constexpr int IndexOf(uint32_t codepoint) const
+		{
+			if (codepoint < 128)
+				return ascii[codepoint];
+
+			int lo = 0;
+			int hi = glyphCount - 1;
+			while (lo <= hi)
+			{
+				int mid = (lo + hi) / 2;
+				if (glyphs[mid].codepoint == codepoint)
+					return mid;
+				if (glyphs[mid].codepoint < codepoint)
+					lo = mid + 1;
+				else
+					hi = mid - 1;
+			}
+
+			return -1;
+		}
+
+		// Usable in static_assert, unlike comparing Find's result against nullptr
+		constexpr bool Has(uint32_t codepoint) const
+		{
+			return IndexOf(codepoint) >= 0;
+		}
+
+		constexpr const EmbeddedGlyph* Find(uint32_t codepoint) const
+		{
+			int index = IndexOf(codepoint);
+			return index < 0 ? nullptr : &glyphs[index];
+		}
+	};
+
 	struct FontDetails
 	{
 		int horizontalBearingX;
@@ -103,14 +196,22 @@ namespace olc
 		int width;
 	};
 
+	template <typename T>
+	class BasicDynamicText;
+
 	class Font
 	{
+		template <typename T>
+		friend class BasicDynamicText;
+
 	public:
 		Font() = default;
 		~Font()
 		{
 			for (auto d : decals)
 				delete d;
+			for (auto s : sprites)
+				delete s;
 		}
 
 
@@ -218,6 +319,54 @@ namespace olc
 			}
 		}
 
+		void DrawString(olc::Sprite* target, const olc::vi2d& origin, std::string_view message, const olc::Pixel& tint = olc::WHITE) const
+		{
+			olc::vi2d spos = { 0, 0 };
+			for (auto c : message)
+			{
+				if (c == '\n')
+				{
+					spos.x = 0;
+					spos.y += fontDetails[c].verticalAdvance;
+				}
+				else
+				{
+					BlendGlyph(
+						target,
+						{ origin.x + spos.x + fontDetails[c].horizontalBearingX, origin.y + spos.y - fontDetails[c].horizontalBearingY },
+						fontDetails[c],
+						tint
+					);
+
+					spos.x += fontDetails[c].horizontalAdvance;
+				}
+			}
+		}
+
+		void DrawStringW(olc::Sprite* target, const olc::vi2d& origin, std::wstring_view message, const olc::Pixel& tint = olc::WHITE) const
+		{
+			olc::vi2d spos = { 0, 0 };
+			for (auto c : message)
+			{
+				if (c == '\n')
+				{
+					spos.x = 0;
+					spos.y += fontDetails[c].verticalAdvance;
+				}
+				else
+				{
+					BlendGlyph(
+						target,
+						{ origin.x + spos.x + fontDetails[c].horizontalBearingX, origin.y + spos.y - fontDetails[c].horizontalBearingY },
+						fontDetails[c],
+						tint
+					);
+
+					spos.x += fontDetails[c].horizontalAdvance;
+				}
+			}
+		}
+
 		void DrawFormatStringW(olc::PixelGameEngine* pge, const olc::vi2d& origin, const olc::vf2d& scale = { 1.0f, 1.0f }, const olc::Pixel& tint = olc::WHITE, const std::wstring message = L"", ...) const
 		{
 			wchar_t buffer[2048];
@@ -319,11 +468,12 @@ namespace olc
 				if (x == '\n')
 				{
 					max_width = line_width > max_width ? line_width : max_width;
-					max_height += abs(max_y - min_y);
+					max_height += max_y > min_y ? max_y - min_y : 0;
 
-					min_y = 0;
-					max_y = 65535;
+					min_y = 65535;
+					max_y = 0;
 					line_width = 0;
+					continue;
 				}
 
 				int tmp_min_y = -fontDetails[x].horizontalBearingY;
@@ -336,9 +486,10 @@ namespace olc
 			}
 
 			max_width = line_width > max_width ? line_width : max_width;
-			max_height += abs(max_y - min_y);
+			max_height += max_y > min_y ? max_y - min_y : 0;
 
-			return { 0, min_y, max_height, max_width };
+			// A line without glyphs (empty string or trailing newline) has no extents
+			return { 0, min_y > max_y ? 0 : min_y, max_height, max_width };
 		}
 
 		olc::bbox<int> MeasureString(std::string_view message)
@@ -354,11 +505,12 @@ namespace olc
 				if (x == '\n')
 				{
 					max_width = line_width > max_width ? line_width : max_width;
-					max_height += abs(max_y - min_y);
-					
-					min_y = 0;
-					max_y = 65535;
+					max_height += max_y > min_y ? max_y - min_y : 0;
+
+					min_y = 65535;
+					max_y = 0;
 					line_width = 0;
+					continue;
 				}
 
 				int tmp_min_y = -fontDetails[x].horizontalBearingY;
@@ -371,13 +523,102 @@ namespace olc
 			}
 
 			max_width = line_width > max_width ? line_width : max_width;
-			max_height += abs(max_y - min_y);
+			max_height += max_y > min_y ? max_y - min_y : 0;
 
-			return { 0, min_y, max_height, max_width };
+			// A line without glyphs (empty string or trailing newline) has no extents
+			return { 0, min_y > max_y ? 0 : min_y, max_height, max_width };
 		}
 
 	protected:
-		
+		// Rounded x / 255 for x in [0, 65535], bit-exact with the SSE2 path
+		static constexpr uint32_t Div255(uint32_t x)
+		{
+			x += 128;
+			return (x + (x >> 8)) >> 8;
+		}
+
+#ifdef OLC_PGEX_FONT_SSE2
+		static __m128i Div255(__m128i x)
+		{
+			x = _mm_add_epi16(x, _mm_set1_epi16(128));
+			return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+		}
+#endif
+
+		// Composites count pixels of glyph coverage (atlas alpha) tinted by tint over dst
+		static void BlendSpan(olc::Pixel* dst, const olc::Pixel* coverage, int count, const olc::Pixel& tint)
+		{
+			int i = 0;
+#ifdef OLC_PGEX_FONT_SSE2
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i full = _mm_set1_epi16(255);
+			const __m128i alpha = _mm_set1_epi32(tint.a);
+			const __m128i colour = _mm_unpacklo_epi8(_mm_set1_epi32((int)(tint.n | 0xFF000000)), zero);
+
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i cov = _mm_srli_epi32(_mm_loadu_si128((const __m128i*)(coverage + i)), 24);
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(cov, zero)) == 0xFFFF)
+					continue;
+
+				// Source alpha, splatted across all four channels of each pixel
+				__m128i a = Div255(_mm_mullo_epi16(cov, alpha));
+				a = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+				a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+
+				__m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+				__m128i alo = _mm_unpacklo_epi8(a, zero);
+				__m128i ahi = _mm_unpackhi_epi8(a, zero);
+
+				__m128i lo = Div255(_mm_add_epi16(_mm_mullo_epi16(colour, alo), _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_sub_epi16(full, alo))));
+				__m128i hi = Div255(_mm_add_epi16(_mm_mullo_epi16(colour, ahi), _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_sub_epi16(full, ahi))));
+
+				_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+			}
+#endif
+			for (; i < count; ++i)
+			{
+				uint32_t a = Div255(coverage[i].a * tint.a);
+				if (a == 0)
+					continue;
+
+				uint32_t ia = 255 - a;
+				dst[i] = olc::Pixel(
+					(uint8_t)Div255(tint.r * a + dst[i].r * ia),
+					(uint8_t)Div255(tint.g * a + dst[i].g * ia),
+					(uint8_t)Div255(tint.b * a + dst[i].b * ia),
+					(uint8_t)Div255(255 * a + dst[i].a * ia)
+				);
+			}
+		}
+
+		void BlendGlyph(olc::Sprite* target, const olc::vi2d& pos, const FontDetails& glyph, const olc::Pixel& tint) const
+		{
+			olc::Sprite* atlas = sprites[glyph.spritemapIndex];
+
+			// Metrics can exceed the glyph's atlas cell, so clamp the source to the atlas
+			int width = std::min(glyph.width, atlas->width - glyph.spritemapOffsetX);
+			int height = std::min(glyph.height, atlas->height - glyph.spritemapOffsetY);
+
+			// Clip the glyph against the target
+			int x0 = std::max(pos.x, 0);
+			int y0 = std::max(pos.y, 0);
+			int x1 = std::min(pos.x + width, target->width);
+			int y1 = std::min(pos.y + height, target->height);
+			if (x0 >= x1 || y0 >= y1)
+				return;
+
+			const olc::Pixel* src = atlas->GetData() + (glyph.spritemapOffsetY + y0 - pos.y) * atlas->width + glyph.spritemapOffsetX + x0 - pos.x;
+			olc::Pixel* dst = target->GetData() + y0 * target->width + x0;
+
+			for (int y = y0; y < y1; ++y)
+			{
+				BlendSpan(dst, src, x1 - x0, tint);
+				src += atlas->width;
+				dst += target->width;
+			}
+		}
+
 		std::vector<olc::Sprite*> sprites;
 		std::vector<olc::Decal*> decals;
 		olc::vi2d sprite_map_size{ 2048, 2048 };
@@ -385,6 +626,7 @@ namespace olc
 		std::vector<FontDetails> fontDetails;
 	};
 
+#ifndef OLC_PGEX_FONT_NO_FREETYPE
 	class TTFFont : public Font
 	{
 	public:
@@ -396,7 +638,8 @@ namespace olc
 			sprite_tile_size = { sprite_map_size.x / tmp, sprite_map_size.y / tmp };
 		}
 
-		bool BuildSprite()
+		// Decals need a running engine, pass false to only build the sprites for software rendering
+		bool BuildSprite(bool create_decals = true)
 		{
 			auto error = FT_Init_FreeType(&library);
 			if (error)
@@ -429,7 +672,7 @@ namespace olc
 
 			int number_of_spritemaps_required = (int)ceil((float)face->num_glyphs / (sprite_tile_size.x * sprite_tile_size.y));
 
-			std::vector<olc::Sprite*> sprites(number_of_spritemaps_required);
+			sprites = std::vector<olc::Sprite*>(number_of_spritemaps_required);
 
 			for (int i = 0; i < number_of_spritemaps_required; ++i)
 			{
@@ -491,8 +734,9 @@ namespace olc
 				}
 			}
 			
-			for (int i = 0; i < number_of_spritemaps_required; ++i)
-				decals.push_back(new olc::Decal(sprites[i]));
+			if (create_decals)
+				for (int i = 0; i < number_of_spritemaps_required; ++i)
+					decals.push_back(new olc::Decal(sprites[i]));
 
 			return true;
 		}
@@ -511,4 +755,225 @@ namespace olc
 		FT_Library library = nullptr;
 		FT_Face face = nullptr;
 	};
+#endif
+
+	class EmbeddedFont : public Font
+	{
+	public:
+		EmbeddedFont(const EmbeddedFontData& data)
+			: data{ data }
+		{
+			uint32_t max_codepoint = data.glyphCount > 0 ? data.glyphs[data.glyphCount - 1].codepoint : 0;
+			fontDetails = std::vector<FontDetails>(max_codepoint < 128 ? 128 : max_codepoint + 1);
+
+			for (int i = 0; i < data.glyphCount; ++i)
+			{
+				auto& glyph = data.glyphs[i];
+				auto& details = fontDetails[glyph.codepoint];
+
+				details.horizontalBearingX = glyph.horizontalBearingX;
+				details.horizontalBearingY = glyph.horizontalBearingY;
+				details.horizontalAdvance = glyph.horizontalAdvance;
+				details.verticalBearingX = glyph.verticalBearingX;
+				details.verticalBearingY = glyph.verticalBearingY;
+				details.verticalAdvance = glyph.verticalAdvance;
+				details.spritemapIndex = 0;
+				details.spritemapOffsetX = glyph.atlasX;
+				details.spritemapOffsetY = glyph.atlasY;
+				details.height = glyph.height;
+				details.width = glyph.width;
+			}
+
+			fontDetails['\n'].verticalAdvance = data.lineHeight;
+		}
+
+		// Only expands the embedded coverage into a sprite, nothing is rasterized
+		bool BuildSprite(bool create_decals = true)
+		{
+			auto sprite = new olc::Sprite(data.atlasWidth, data.atlasHeight);
+			olc::Pixel* pixels = sprite->GetData();
+			for (int i = 0; i < data.atlasWidth * data.atlasHeight; ++i)
+				pixels[i] = olc::Pixel(255, 255, 255, data.atlas[i]);
+
+			sprites.push_back(sprite);
+			if (create_decals)
+				decals.push_back(new olc::Decal(sprite));
+
+			return true;
+		}
+
+	private:
+		EmbeddedFontData data;
+	};
+
+	// Glyph quad plus the running layout state after its character, so any
+	// prefix of the string can be resumed without walking it again
+	struct DynamicGlyph
+	{
+		olc::vi2d pen;
+		olc::vi2d bearing;
+		olc::vf2d sourcePos;
+		olc::vf2d sourceSize;
+		int spritemapIndex;
+		bool visible;
+
+		olc::vi2d nextPen;
+		int maxWidth;
+		int maxHeight;
+		int minY;
+		int maxY;
+	};
+
+	template <typename T>
+	class BasicDynamicText
+	{
+	public:
+		BasicDynamicText(const Font* font, size_t capacity = 64)
+			: font{ font }
+		{
+			Reserve(capacity);
+		}
+
+		void Reserve(size_t capacity)
+		{
+			text.reserve(capacity);
+			glyphs.reserve(capacity);
+		}
+
+		// Returns the index of the first changed character, or the length if nothing changed
+		size_t Set(std::basic_string_view<T> message)
+		{
+			size_t common = std::min(text.size(), message.size());
+			size_t first = std::mismatch(text.begin(), text.begin() + common, message.begin()).first - text.begin();
+
+			if (first == text.size() && first == message.size())
+				return first;
+
+			text.resize(message.size());
+			std::copy(message.begin() + first, message.end(), text.begin() + first);
+			glyphs.resize(message.size());
+			Layout(first);
+
+			return first;
+		}
+
+		void Draw(olc::PixelGameEngine* pge, const olc::vi2d& origin, const olc::vf2d& scale = { 1.0f, 1.0f }, const olc::Pixel& tint = olc::WHITE) const
+		{
+			for (auto& g : glyphs)
+			{
+				if (!g.visible)
+					continue;
+
+				pge->DrawPartialDecal(
+					{ origin.x + g.pen.x * scale.x + g.bearing.x, origin.y + g.pen.y * scale.y + g.bearing.y },
+					font->decals[g.spritemapIndex],
+					g.sourcePos,
+					g.sourceSize,
+					scale,
+					tint
+				);
+			}
+		}
+
+		void Draw(olc::Sprite* target, const olc::vi2d& origin, const olc::Pixel& tint = olc::WHITE) const
+		{
+			for (size_t i = 0; i < glyphs.size(); ++i)
+			{
+				if (glyphs[i].visible)
+					font->BlendGlyph(target, origin + glyphs[i].pen + glyphs[i].bearing, font->fontDetails[text[i]], tint);
+			}
+		}
+
+		// Same result as Font::MeasureString on the current text, without walking it
+		olc::bbox<int> Measure() const
+		{
+			if (glyphs.empty())
+				return { 0, 0, 0, 0 };
+
+			auto& g = glyphs.back();
+			int width = g.nextPen.x > g.maxWidth ? g.nextPen.x : g.maxWidth;
+			int height = g.maxHeight + (g.maxY > g.minY ? g.maxY - g.minY : 0);
+
+			return { 0, g.minY > g.maxY ? 0 : g.minY, height, width };
+		}
+
+		const std::basic_string<T>& GetText() const
+		{
+			return text;
+		}
+
+		const std::vector<DynamicGlyph>& GetGlyphs() const
+		{
+			return glyphs;
+		}
+
+	private:
+		void Layout(size_t from)
+		{
+			olc::vi2d pen = { 0, 0 };
+			int max_width = 0;
+			int max_height = 0;
+			int min_y = 65535;
+			int max_y = 0;
+
+			if (from > 0)
+			{
+				auto& prev = glyphs[from - 1];
+				pen = prev.nextPen;
+				max_width = prev.maxWidth;
+				max_height = prev.maxHeight;
+				min_y = prev.minY;
+				max_y = prev.maxY;
+			}
+
+			for (size_t i = from; i < text.size(); ++i)
+			{
+				auto c = text[i];
+				auto& details = font->fontDetails[c];
+				auto& g = glyphs[i];
+
+				g.pen = pen;
+				if (c == '\n')
+				{
+					g.visible = false;
+
+					max_width = pen.x > max_width ? pen.x : max_width;
+					max_height += max_y > min_y ? max_y - min_y : 0;
+					min_y = 65535;
+					max_y = 0;
+
+					pen.x = 0;
+					pen.y += details.verticalAdvance;
+				}
+				else
+				{
+					g.visible = true;
+					g.bearing = { details.horizontalBearingX, -details.horizontalBearingY };
+					g.sourcePos = { (float)details.spritemapOffsetX, (float)details.spritemapOffsetY };
+					g.sourceSize = { (float)details.width, (float)details.height };
+					g.spritemapIndex = details.spritemapIndex;
+
+					int tmp_min_y = -details.horizontalBearingY;
+					int tmp_max_y = tmp_min_y + details.height;
+					min_y = tmp_min_y < min_y ? tmp_min_y : min_y;
+					max_y = tmp_max_y > max_y ? tmp_max_y : max_y;
+
+					pen.x += details.horizontalAdvance;
+				}
+
+				g.nextPen = pen;
+				g.maxWidth = max_width;
+				g.maxHeight = max_height;
+				g.minY = min_y;
+				g.maxY = max_y;
+			}
+		}
+
+		const Font* font = nullptr;
+		std::basic_string<T> text;
+		std::vector<DynamicGlyph> glyphs;
+	};
+
+	using DynamicText = BasicDynamicText<char>;
+	using DynamicTextW = BasicDynamicText<wchar_t>;
 }
\ No newline at end of file
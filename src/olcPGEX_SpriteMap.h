@@ -61,40 +61,131 @@
 
 	spritemap->DrawSpriteMap(this, { 32, 16 });
 
+	std::vector<olc::SpriteInstance> particles = { { 0, { 16, 64 } }, { 1, { 32, 64 }, { 2.0f, 2.0f }, olc::RED } };
+	spritemap->DrawBatch(this, particles);
+
 */
 
 #pragma once
 
+#include <vector>
+
 namespace olc
 {
+	// Source rectangle of a single frame, with its UVs precomputed for batching
+	struct SpriteFrame
+	{
+		olc::vf2d offset;
+		olc::vf2d size;
+		olc::vf2d uvTopLeft;
+		olc::vf2d uvBottomRight;
+	};
+
+	struct SpriteInstance
+	{
+		int32_t idx;
+		olc::vf2d position;
+		olc::vf2d scale = { 1.0f, 1.0f };
+		olc::Pixel tint = olc::WHITE;
+	};
+
 	class SpriteMap
 	{
 	public:
 		SpriteMap() = default;
-		SpriteMap(olc::Decal* decal, const olc::vi2d& size)
+		SpriteMap(olc::Decal* decal, const olc::vi2d& size, const olc::vi2d& margin = { 0, 0 }, const olc::vi2d& spacing = { 0, 0 })
 			: decal{ decal }, sprite_size{ size }
 		{
-			width = decal->sprite->width / size.x;
-			height = decal->sprite->height / size.y;
+			width = (decal->sprite->width - 2 * margin.x + spacing.x) / (size.x + spacing.x);
+			height = (decal->sprite->height - 2 * margin.y + spacing.y) / (size.y + spacing.y);
+
+			frames.reserve(width * height);
+			for (int row = 0; row < height; ++row)
+			{
+				for (int col = 0; col < width; ++col)
+				{
+					SpriteFrame frame;
+					frame.offset = { (float)(margin.x + col * (size.x + spacing.x)), (float)(margin.y + row * (size.y + spacing.y)) };
+					frame.size = size;
+					frames.push_back(frame);
+				}
+			}
+
+			BuildUVs();
+		}
+
+		// Non-uniform frames, indexed in the order given
+		SpriteMap(olc::Decal* decal, const std::vector<SpriteFrame>& frames)
+			: decal{ decal }, frames{ frames }
+		{
+			width = (int32_t)frames.size();
+			height = 1;
+			if (!frames.empty())
+				sprite_size = frames[0].size;
+
+			BuildUVs();
 		}
 		~SpriteMap() = default;
 
 		void Draw(olc::PixelGameEngine* pge, int idx, olc::vf2d position, const olc::vf2d& scale = { 1.0f, 1.0f }, const olc::Pixel& tint = olc::WHITE)
 		{
-			int row = idx / width;
-			int col = idx % width;
-			olc::vi2d drawoffset = { col * sprite_size.x, row * sprite_size.y };
-			
-			pge->DrawPartialDecal(position, decal, drawoffset, sprite_size, scale, tint);
+			const auto& frame = frames[idx];
+			pge->DrawPartialDecal(position, decal, frame.offset, frame.size, scale, tint);
 		}
 
 		void DrawRotated(olc::PixelGameEngine* pge, int idx, olc::vi2d position, float angle, const olc::vf2d& center_of_rotation, const olc::vf2d& scale = { 1.0f, 1.0f }, const olc::Pixel& tint = olc::WHITE)
 		{
-			int row = idx / width;
-			int col = idx % width;
-			olc::vi2d drawoffset = { col * sprite_size.x, row * sprite_size.y };
+			const auto& frame = frames[idx];
+			pge->DrawPartialRotatedDecal(position, decal, angle, center_of_rotation, frame.offset, frame.size, scale, tint);
+		}
+
+		// Submits every instance as a single triangle list decal, rather than one decal per sprite
+		void DrawBatch(olc::PixelGameEngine* pge, const SpriteInstance* instances, size_t count)
+		{
+			if (count == 0)
+				return;
+
+			batch_pos.resize(count * 6);
+			batch_uv.resize(count * 6);
+			batch_tint.resize(count * 6);
+
+			olc::vf2d* pos = batch_pos.data();
+			olc::vf2d* uv = batch_uv.data();
+			olc::Pixel* tint = batch_tint.data();
+
+			for (size_t i = 0; i < count; ++i, pos += 6, uv += 6, tint += 6)
+			{
+				const auto& instance = instances[i];
+				const auto& frame = frames[instance.idx];
+
+				float x0 = instance.position.x;
+				float y0 = instance.position.y;
+				float x1 = x0 + frame.size.x * instance.scale.x;
+				float y1 = y0 + frame.size.y * instance.scale.y;
+				float u0 = frame.uvTopLeft.x;
+				float v0 = frame.uvTopLeft.y;
+				float u1 = frame.uvBottomRight.x;
+				float v1 = frame.uvBottomRight.y;
+
+				pos[0] = { x0, y0 }; uv[0] = { u0, v0 };
+				pos[1] = { x0, y1 }; uv[1] = { u0, v1 };
+				pos[2] = { x1, y1 }; uv[2] = { u1, v1 };
+				pos[3] = { x0, y0 }; uv[3] = { u0, v0 };
+				pos[4] = { x1, y1 }; uv[4] = { u1, v1 };
+				pos[5] = { x1, y0 }; uv[5] = { u1, v0 };
+
+				for (int v = 0; v < 6; ++v)
+					tint[v] = instance.tint;
+			}
+
+			pge->SetDecalStructure(olc::DecalStructure::LIST);
+			pge->DrawPolygonDecal(decal, batch_pos, batch_uv, batch_tint);
+			pge->SetDecalStructure(olc::DecalStructure::FAN);
+		}
 
-			pge->DrawPartialRotatedDecal(position, decal, angle, center_of_rotation, drawoffset, sprite_size, scale, tint);
+		void DrawBatch(olc::PixelGameEngine* pge, const std::vector<SpriteInstance>& instances)
+		{
+			DrawBatch(pge, instances.data(), instances.size());
 		}
 
 		void DrawSpriteMap(olc::PixelGameEngine* pge, const olc::vi2d& position, const olc::vf2d& scale = { 1.0f, 1.0f }, const olc::Pixel& tint = olc::WHITE)
@@ -106,5 +197,22 @@ namespace olc
 		int32_t width = 0;
 		int32_t height = 0;
 		olc::Decal* decal = nullptr;
+		std::vector<SpriteFrame> frames;
+
+	private:
+		void BuildUVs()
+		{
+			olc::vf2d uv_scale = { 1.0f / decal->sprite->width, 1.0f / decal->sprite->height };
+			for (auto& frame : frames)
+			{
+				frame.uvTopLeft = { frame.offset.x * uv_scale.x, frame.offset.y * uv_scale.y };
+				frame.uvBottomRight = { (frame.offset.x + frame.size.x) * uv_scale.x, (frame.offset.y + frame.size.y) * uv_scale.y };
+			}
+		}
+
+		// Reused between batches so steady state drawing does not allocate
+		std::vector<olc::vf2d> batch_pos;
+		std::vector<olc::vf2d> batch_uv;
+		std::vector<olc::Pixel> batch_tint;
 	};
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+
 #include "olcPGEX_SpriteMap.h"
 
 namespace olc
@@ -58,8 +60,58 @@ namespace olc
 			{
 				for (int col = 0; col < stride; ++col)
 				{
-					vf2d offset = { position.x + col, position.y + row };
-					spritemap->Draw(pge, sprites[idx++], offset, scale, tint); // * spritemap->sprite_size
+					vf2d offset = { position.x + col * spritemap->sprite_size.x * scale.x, position.y + row * spritemap->sprite_size.y * scale.y };
+					spritemap->Draw(pge, sprites[idx++], offset, scale, tint);
+				}
+			}
+		}
+
+		// Pixel extent of the sub-sprites, measured from the tile's position
+		vi2d Extent() const
+		{
+			vi2d extent = { 0, 0 };
+			int idx = 0;
+			for (int row = 0; row < height; ++row)
+			{
+				for (int col = 0; col < stride; ++col)
+				{
+					const auto& frame = spritemap->frames[sprites[idx++]];
+					extent.x = std::max(extent.x, col * spritemap->sprite_size.x + (int)frame.size.x);
+					extent.y = std::max(extent.y, row * spritemap->sprite_size.y + (int)frame.size.y);
+				}
+			}
+
+			return extent;
+		}
+
+		// Alpha blends the tile's pixels over target, as drawing it with Draw would, clipped to target
+		void Bake(Sprite* target, const vi2d& position) const
+		{
+			Sprite* source = spritemap->decal->sprite;
+			int idx = 0;
+			for (int row = 0; row < height; ++row)
+			{
+				for (int col = 0; col < stride; ++col)
+				{
+					const auto& frame = spritemap->frames[sprites[idx++]];
+					vi2d src = frame.offset;
+					vi2d dst = { position.x + col * spritemap->sprite_size.x, position.y + row * spritemap->sprite_size.y };
+
+					int x0 = std::max(0, -dst.x);
+					int y0 = std::max(0, -dst.y);
+					int x1 = std::min((int)frame.size.x, target->width - dst.x);
+					int y1 = std::min((int)frame.size.y, target->height - dst.y);
+
+					for (int y = y0; y < y1; ++y)
+					{
+						Pixel* out = target->GetData() + (dst.y + y) * target->width + dst.x;
+						for (int x = x0; x < x1; ++x)
+						{
+							Pixel p = source->GetPixel(src.x + x, src.y + y);
+							if (p.a != 0)
+								out[x] = BlendOver(p, out[x]);
+						}
+					}
 				}
 			}
 		}
@@ -103,6 +155,23 @@ namespace olc
 		TileAttributes attributes = TileAttributes::NONE;
 
 	private:
+		// Non-premultiplied source over destination
+		static Pixel BlendOver(const Pixel& src, const Pixel& dst)
+		{
+			if (src.a == 255 || dst.a == 0)
+				return src;
+
+			int sa = src.a;
+			int da = dst.a * (255 - sa) / 255;
+			int oa = sa + da;
+			return Pixel(
+				(uint8_t)((src.r * sa + dst.r * da) / oa),
+				(uint8_t)((src.g * sa + dst.g * da) / oa),
+				(uint8_t)((src.b * sa + dst.b * da) / oa),
+				(uint8_t)oa
+			);
+		}
+
 		SpriteMap* spritemap = nullptr;
 		int stride = 0;
 		int height = 0;
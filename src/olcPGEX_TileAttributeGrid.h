@@ -0,0 +1,295 @@
+/*
+	olcPGEX_TileAttributeGrid.h
+
+	+-------------------------------------------------------------+
+	|         OneLoneCoder Pixel Game Engine Extension            |
+	|                  TileAttributeGrid 1.0                      |
+	+-------------------------------------------------------------+
+
+	What is this?
+	~~~~~~~~~~~~~~~
+	This is an extension to the olcPixelGameEngine, which stores the
+	TileAttributes of a whole map as one bitplane per flag, so queries
+	over regions and rows test 64 tiles at a time, alongside a dense
+	flag array for single tile queries.
+
+	License (The Unlicense)
+	~~~~~~~~~~~~~~~
+
+	This is free and unencumbered software released into the public domain.
+
+	Anyone is free to copy, modify, publish, use, compile, sell, or
+	distribute this software, either in source code form or as a compiled
+	binary, for any purpose, commercial or non-commercial, and by any
+	means.
+
+	In jurisdictions that recognize copyright laws, the author or authors
+	of this software dedicate any and all copyright interest in the
+	software to the public domain. We make this dedication for the benefit
+	of the public at large and to the detriment of our heirs and
+	successors. We intend this dedication to be an overt act of
+	relinquishment in perpetuity of all present and future rights to this
+	software under copyright law.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+	OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+	ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+
+	For more information, please refer to <https://unlicense.org>
+
+  Author & Contributors
+  ~~~~~~~~~~~~~~~
+
+  Ayodehi
+*/
+
+/*
+	Example
+	~~~~~~~
+
+	#include "olcPGEX_TileAttributeGrid.h"
+
+	olc::TileAttributeGrid grid({ 256, 256 });
+	map->ExportAttributes(grid);
+
+	bool walk = grid.CanWalk({ 4, 7 });
+	olc::TileAttributes around = grid.RegionUnion({ 0, 0 }, { 8, 8 });
+	int water = grid.ScanRow(7, 0, olc::TileAttributes::REQUIRES_BOAT);
+
+	std::vector<uint64_t> walkable;
+	grid.WalkableMask({ 0, 0 }, { 32, 16 }, walkable); // 1 bit per tile, rows padded to 64 tiles
+
+	std::vector<uint8_t> passability;
+	grid.ExportPassability(passability); // 1 byte per tile, 1 = walkable
+
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "olcPGEX_Tile.h"
+
+namespace olc
+{
+	class TileAttributeGrid
+	{
+	public:
+		// One plane per defined flag, WALK through PARTIAL_HIDE_PLAYER
+		static constexpr int plane_count = 5;
+
+		// Attributes that prevent walking, see Tile::canWalk
+		static constexpr TileAttributes blocking = static_cast<TileAttributes>(
+			static_cast<int>(TileAttributes::REQUIRES_CANOE) | static_cast<int>(TileAttributes::REQUIRES_BOAT) | static_cast<int>(TileAttributes::REQUIRES_AIRSHIP));
+
+		TileAttributeGrid() = default;
+		TileAttributeGrid(const vi2d& size)
+		{
+			Resize(size);
+		}
+
+		void Resize(const vi2d& new_size)
+		{
+			size = new_size;
+			words_per_row = (size.x + 63) / 64;
+			row_stride = words_per_row + 1; // Trailing zero word so Extract never needs a bounds check
+			planes = std::vector<uint64_t>((size_t)plane_count * size.y * row_stride, 0);
+			flags = std::vector<uint8_t>((size_t)size.x * size.y, 0);
+		}
+
+		void Set(const vi2d& pos, TileAttributes attributes)
+		{
+			flags[(size_t)pos.y * size.x + pos.x] = (uint8_t)(static_cast<int>(attributes) & ((1 << plane_count) - 1));
+
+			uint64_t bit = 1ull << (pos.x & 63);
+			for (int p = 0; p < plane_count; ++p)
+			{
+				uint64_t& word = Row(p, pos.y)[pos.x >> 6];
+				if (static_cast<int>(attributes) & (1 << p))
+					word |= bit;
+				else
+					word &= ~bit;
+			}
+		}
+
+		TileAttributes Get(const vi2d& pos) const
+		{
+			return static_cast<TileAttributes>(flags[(size_t)pos.y * size.x + pos.x]);
+		}
+
+		void SetAttribute(const vi2d& pos, TileAttributes attrib)
+		{
+			Set(pos, Get(pos) | attrib);
+		}
+
+		void UnsetAttribute(const vi2d& pos, TileAttributes attrib)
+		{
+			Set(pos, Get(pos) & ~attrib);
+		}
+
+		bool HasAttribute(const vi2d& pos, TileAttributes attrib) const
+		{
+			return (flags[(size_t)pos.y * size.x + pos.x] & static_cast<int>(attrib)) != 0;
+		}
+
+		bool CanWalk(const vi2d& pos) const
+		{
+			return (flags[(size_t)pos.y * size.x + pos.x] & static_cast<int>(blocking)) == 0;
+		}
+
+		// Union of the attributes of every tile in the region
+		TileAttributes RegionUnion(const vi2d& pos, const vi2d& region) const
+		{
+			int result = 0;
+			for (int p = 0; p < plane_count; ++p)
+			{
+				for (int y = pos.y; y < pos.y + region.y; ++y)
+				{
+					if (AnyInRow(p, y, pos.x, region.x))
+					{
+						result |= 1 << p;
+						break;
+					}
+				}
+			}
+
+			return static_cast<TileAttributes>(result);
+		}
+
+		// One bit per tile, set where the tile is walkable. Each of the region.y rows is
+		// (region.x + 63) / 64 words, bit i of a row is the tile at pos.x + i
+		void WalkableMask(const vi2d& pos, const vi2d& region, std::vector<uint64_t>& out) const
+		{
+			int out_words = (region.x + 63) / 64;
+			out.resize((size_t)out_words * region.y);
+
+			uint64_t* dst = out.data();
+			for (int y = pos.y; y < pos.y + region.y; ++y, dst += out_words)
+			{
+				for (int w = 0; w < out_words; ++w)
+				{
+					uint64_t blocked = 0;
+					for (int p = 0; p < plane_count; ++p)
+						if (static_cast<int>(blocking) & (1 << p))
+							blocked |= Extract(p, y, pos.x + w * 64);
+
+					dst[w] = ~blocked & TailMask(region.x - w * 64);
+				}
+			}
+		}
+
+		// Returns the first x >= start in row y which has any of attrib (or none of it, when
+		// has is false), or -1 if there is none
+		int ScanRow(int y, int start, TileAttributes attrib, bool has = true) const
+		{
+			for (int w = start >> 6; w < words_per_row; ++w)
+			{
+				uint64_t word = 0;
+				for (int p = 0; p < plane_count; ++p)
+					if (static_cast<int>(attrib) & (1 << p))
+						word |= Row(p, y)[w];
+
+				if (!has)
+					word = ~word & TailMask(size.x - w * 64);
+				if (w == start >> 6)
+					word &= ~0ull << (start & 63);
+
+				if (word != 0)
+					return w * 64 + CountTrailingZeros(word);
+			}
+
+			return -1;
+		}
+
+		// Dense passability map for pathfinders, one byte per tile in row order, 1 = walkable
+		void ExportPassability(std::vector<uint8_t>& out) const
+		{
+			out.resize((size_t)size.x * size.y);
+
+			uint8_t* dst = out.data();
+			for (int y = 0; y < size.y; ++y)
+			{
+				for (int w = 0; w < words_per_row; ++w)
+				{
+					uint64_t blocked = 0;
+					for (int p = 0; p < plane_count; ++p)
+						if (static_cast<int>(blocking) & (1 << p))
+							blocked |= Row(p, y)[w];
+
+					int count = size.x - w * 64 < 64 ? size.x - w * 64 : 64;
+					for (int b = 0; b < count; ++b)
+						*dst++ = (uint8_t)(~blocked >> b & 1);
+				}
+			}
+		}
+
+		// Bit packed passability map, see WalkableMask
+		void ExportPassabilityBits(std::vector<uint64_t>& out) const
+		{
+			WalkableMask({ 0, 0 }, size, out);
+		}
+
+		vi2d size;
+
+	private:
+		uint64_t* Row(int plane, int y)
+		{
+			return &planes[((size_t)plane * size.y + y) * row_stride];
+		}
+
+		const uint64_t* Row(int plane, int y) const
+		{
+			return &planes[((size_t)plane * size.y + y) * row_stride];
+		}
+
+		// 64 tiles of a plane starting at x < size.x, tiles past the right edge read as 0
+		uint64_t Extract(int plane, int y, int x) const
+		{
+			const uint64_t* row = Row(plane, y) + (x >> 6);
+			int s = x & 63;
+
+			// Shifting hi in two steps keeps the shift below 64 when s is 0
+			return (row[0] >> s) | ((row[1] << 1) << (63 - s));
+		}
+
+		bool AnyInRow(int plane, int y, int x, int count) const
+		{
+			for (int w = 0; w * 64 < count; ++w)
+				if (Extract(plane, y, x + w * 64) & TailMask(count - w * 64))
+					return true;
+
+			return false;
+		}
+
+		// Low n bits set, all of them when n >= 64
+		static uint64_t TailMask(int n)
+		{
+			return n >= 64 ? ~0ull : (1ull << n) - 1;
+		}
+
+		static int CountTrailingZeros(uint64_t v)
+		{
+#if defined(_MSC_VER)
+			unsigned long idx;
+			_BitScanForward64(&idx, v);
+			return (int)idx;
+#else
+			return __builtin_ctzll(v);
+#endif
+		}
+
+		int words_per_row = 0;
+		int row_stride = 0;
+		std::vector<uint64_t> planes;
+		std::vector<uint8_t> flags;
+	};
+}
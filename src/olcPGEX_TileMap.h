@@ -0,0 +1,290 @@
+/*
+	olcPGEX_TileMap.h
+
+	+-------------------------------------------------------------+
+	|         OneLoneCoder Pixel Game Engine Extension            |
+	|                      TileMap 1.0                            |
+	+-------------------------------------------------------------+
+
+	What is this?
+	~~~~~~~~~~~~~~~
+	This is an extension to the olcPixelGameEngine, which provides
+	a chunked tilemap. Chunks outside of the view are skipped and
+	static chunks are baked into a single decal, rebaked only when
+	one of their tiles changes. Tiles larger than a cell spill into
+	the cells, and chunks, to their right and below.
+
+	License (The Unlicense)
+	~~~~~~~~~~~~~~~
+
+	This is free and unencumbered software released into the public domain.
+
+	Anyone is free to copy, modify, publish, use, compile, sell, or
+	distribute this software, either in source code form or as a compiled
+	binary, for any purpose, commercial or non-commercial, and by any
+	means.
+
+	In jurisdictions that recognize copyright laws, the author or authors
+	of this software dedicate any and all copyright interest in the
+	software to the public domain. We make this dedication for the benefit
+	of the public at large and to the detriment of our heirs and
+	successors. We intend this dedication to be an overt act of
+	relinquishment in perpetuity of all present and future rights to this
+	software under copyright law.
+
+	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+	MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+	IN NO EVENT SHALL THE AUTHORS BE LIABLE FOR ANY CLAIM, DAMAGES OR
+	OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+	ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+	OTHER DEALINGS IN THE SOFTWARE.
+
+	For more information, please refer to <https://unlicense.org>
+
+  Author & Contributors
+  ~~~~~~~~~~~~~~~
+
+  Ayodehi
+*/
+
+/*
+	Example
+	~~~~~~~
+
+	#include "olcPGEX_TileMap.h"
+
+	std::vector<olc::Tile*> tileset = { grass, water, tree };
+	auto map = new olc::TileMap(tileset, { 256, 256 }, { 16, 16 });
+
+	map->SetTile({ 4, 7 }, 1);
+	map->SetChunkDynamic({ 0, 0 }, true); // Animated chunk, drawn tile by tile
+
+	map->Draw(this, camera);
+
+	olc::TileAttributeGrid grid;
+	map->ExportAttributes(grid);
+
+*/
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#include "olcPGEX_Tile.h"
+#include "olcPGEX_TileAttributeGrid.h"
+
+namespace olc
+{
+	class TileMap
+	{
+	public:
+		// Tiles are referenced by their index in tileset, -1 is an empty cell
+		TileMap(const std::vector<Tile*>& tileset, const vi2d& size, const vi2d& tile_size, int chunk_size = 16)
+			: size{ size }, tile_size{ tile_size }, chunk_size{ chunk_size }, tileset{ tileset }
+		{
+			chunk_count = { (size.x + chunk_size - 1) / chunk_size, (size.y + chunk_size - 1) / chunk_size };
+			chunks = std::vector<Chunk>(chunk_count.x * chunk_count.y);
+			for (auto& chunk : chunks)
+				chunk.tiles = std::vector<int>(chunk_size * chunk_size, -1);
+
+			// How many cells the largest tile spills past its own
+			overhang = { 0, 0 };
+			for (auto tile : tileset)
+			{
+				if (tile == nullptr)
+					continue;
+
+				vi2d extent = tile->Extent();
+				overhang.x = std::max(overhang.x, (extent.x - 1) / tile_size.x);
+				overhang.y = std::max(overhang.y, (extent.y - 1) / tile_size.y);
+			}
+		}
+
+		TileMap(const TileMap&) = delete;
+		TileMap& operator=(const TileMap&) = delete;
+
+		~TileMap()
+		{
+			for (auto& chunk : chunks)
+			{
+				delete chunk.decal;
+				delete chunk.sprite;
+			}
+		}
+
+		void SetTile(const vi2d& pos, int tile)
+		{
+			auto& chunk = chunks[(pos.y / chunk_size) * chunk_count.x + pos.x / chunk_size];
+			int& cell = chunk.tiles[(pos.y % chunk_size) * chunk_size + pos.x % chunk_size];
+			if (cell != tile)
+			{
+				cell = tile;
+				MarkDirty(pos, pos);
+			}
+		}
+
+		int GetTile(const vi2d& pos) const
+		{
+			const auto& chunk = chunks[(pos.y / chunk_size) * chunk_count.x + pos.x / chunk_size];
+			return chunk.tiles[(pos.y % chunk_size) * chunk_size + pos.x % chunk_size];
+		}
+
+		Tile* GetTileObject(const vi2d& pos) const
+		{
+			int tile = GetTile(pos);
+			return tile < 0 ? nullptr : tileset[tile];
+		}
+
+		// Dynamic chunks are never baked and draw their tiles every frame
+		void SetChunkDynamic(const vi2d& chunk, bool dynamic)
+		{
+			auto& c = chunks[chunk.y * chunk_count.x + chunk.x];
+			if (c.dynamic != dynamic)
+			{
+				c.dynamic = dynamic;
+				MarkDirty(chunk * chunk_size, chunk * chunk_size + vi2d{ chunk_size - 1, chunk_size - 1 });
+			}
+		}
+
+		// Forces every chunk to be rebaked, e.g. after the tileset's sprites change
+		void Invalidate()
+		{
+			for (auto& chunk : chunks)
+				chunk.dirty = true;
+		}
+
+		// Writes the attributes of every cell into grid, empty cells are NONE
+		void ExportAttributes(TileAttributeGrid& grid) const
+		{
+			grid.Resize(size);
+			for (int y = 0; y < size.y; ++y)
+				for (int x = 0; x < size.x; ++x)
+				{
+					Tile* tile = GetTileObject({ x, y });
+					if (tile != nullptr)
+						grid.Set({ x, y }, tile->attributes);
+				}
+		}
+
+		// camera is the world position, in pixels, of the top left of the screen
+		void Draw(PixelGameEngine* pge, const vf2d& camera, const vf2d& scale = { 1.0f, 1.0f }, const Pixel& tint = WHITE)
+		{
+			vf2d chunk_pixels = { (float)(chunk_size * tile_size.x), (float)(chunk_size * tile_size.y) };
+			vf2d view = { pge->ScreenWidth() / scale.x, pge->ScreenHeight() / scale.y };
+
+			// Dynamic chunks left of or above the view may still spill into it
+			int first_x = std::max(0, (int)std::floor((camera.x - overhang.x * tile_size.x) / chunk_pixels.x));
+			int first_y = std::max(0, (int)std::floor((camera.y - overhang.y * tile_size.y) / chunk_pixels.y));
+			int last_x = std::min(chunk_count.x - 1, (int)std::floor((camera.x + view.x) / chunk_pixels.x));
+			int last_y = std::min(chunk_count.y - 1, (int)std::floor((camera.y + view.y) / chunk_pixels.y));
+
+			for (int cy = first_y; cy <= last_y; ++cy)
+			{
+				for (int cx = first_x; cx <= last_x; ++cx)
+				{
+					auto& chunk = chunks[cy * chunk_count.x + cx];
+					vf2d screen = { (cx * chunk_pixels.x - camera.x) * scale.x, (cy * chunk_pixels.y - camera.y) * scale.y };
+
+					if (chunk.dynamic)
+					{
+						DrawChunkTiles(pge, chunk, screen, scale, tint);
+						continue;
+					}
+
+					if ((cx + 1) * chunk_pixels.x <= camera.x || (cy + 1) * chunk_pixels.y <= camera.y)
+						continue;
+
+					if (chunk.dirty)
+						Bake({ cx, cy });
+
+					pge->DrawDecal(screen, chunk.decal, scale, tint);
+				}
+			}
+		}
+
+		vi2d size;
+		vi2d tile_size;
+		int chunk_size = 16;
+
+	private:
+		struct Chunk
+		{
+			std::vector<int> tiles;
+			Sprite* sprite = nullptr;
+			Decal* decal = nullptr;
+			bool dirty = true;
+			bool dynamic = false;
+		};
+
+		void DrawChunkTiles(PixelGameEngine* pge, const Chunk& chunk, const vf2d& screen, const vf2d& scale, const Pixel& tint) const
+		{
+			int idx = 0;
+			for (int row = 0; row < chunk_size; ++row)
+			{
+				for (int col = 0; col < chunk_size; ++col)
+				{
+					int tile = chunk.tiles[idx++];
+					if (tile < 0)
+						continue;
+
+					vf2d position = { screen.x + col * tile_size.x * scale.x, screen.y + row * tile_size.y * scale.y };
+					tileset[tile]->Draw(pge, position, scale, tint);
+				}
+			}
+		}
+
+		// Marks every chunk showing any of the cells from first to last, including spill over
+		void MarkDirty(const vi2d& first, const vi2d& last)
+		{
+			int x1 = std::min(size.x - 1, last.x + overhang.x) / chunk_size;
+			int y1 = std::min(size.y - 1, last.y + overhang.y) / chunk_size;
+			for (int cy = first.y / chunk_size; cy <= y1; ++cy)
+				for (int cx = first.x / chunk_size; cx <= x1; ++cx)
+					chunks[cy * chunk_count.x + cx].dirty = true;
+		}
+
+		void Bake(const vi2d& chunk_pos)
+		{
+			auto& chunk = chunks[chunk_pos.y * chunk_count.x + chunk_pos.x];
+
+			if (chunk.sprite == nullptr)
+				chunk.sprite = new Sprite(chunk_size * tile_size.x, chunk_size * tile_size.y);
+
+			std::fill(chunk.sprite->GetData(), chunk.sprite->GetData() + chunk.sprite->width * chunk.sprite->height, Pixel(0, 0, 0, 0));
+
+			// Cells from neighbouring chunks can spill into this one, dynamic chunks draw their own
+			vi2d origin = chunk_pos * chunk_size;
+			int x0 = std::max(0, origin.x - overhang.x);
+			int y0 = std::max(0, origin.y - overhang.y);
+			int x1 = std::min(size.x, origin.x + chunk_size);
+			int y1 = std::min(size.y, origin.y + chunk_size);
+
+			for (int y = y0; y < y1; ++y)
+			{
+				for (int x = x0; x < x1; ++x)
+				{
+					int tile = GetTile({ x, y });
+					if (tile < 0 || chunks[(y / chunk_size) * chunk_count.x + x / chunk_size].dynamic)
+						continue;
+
+					tileset[tile]->Bake(chunk.sprite, { (x - origin.x) * tile_size.x, (y - origin.y) * tile_size.y });
+				}
+			}
+
+			if (chunk.decal == nullptr)
+				chunk.decal = new Decal(chunk.sprite);
+			else
+				chunk.decal->Update();
+
+			chunk.dirty = false;
+		}
+
+		std::vector<Tile*> tileset;
+		std::vector<Chunk> chunks;
+		vi2d chunk_count;
+		vi2d overhang;
+	};
+}
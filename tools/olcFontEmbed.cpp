@@ -0,0 +1,265 @@
+/*
+	olcFontEmbed.cpp
+
+	Generates a header for olc::EmbeddedFont from a TTF/OTF font, so the
+	font needs neither FreeType nor file I/O at runtime.
+
+	Only depends on FreeType and the standard library:
+
+	g++ -std=c++17 olcFontEmbed.cpp -I/usr/include/freetype2 -lfreetype -o olcFontEmbed
+
+	Usage
+	~~~~~
+
+	olcFontEmbed <font> <size> <name> <output.h> [glyphs]
+
+	glyphs is a comma separated list of codepoints and ranges, decimal or
+	hex, defaulting to printable ASCII: "32-126" or "32-126,0x3040-0x309F"
+
+	The generated header defines olc::embedded::<name>, an
+	olc::EmbeddedFontData, and includes olcPGEX_Font.h. Define
+	OLC_PGEX_FONT_NO_FREETYPE before including it to drop the FreeType
+	dependency entirely.
+
+	License (The Unlicense)
+	~~~~~~~~~~~~~~~
+
+	This is free and unencumbered software released into the public domain.
+
+	For more information, please refer to <https://unlicense.org>
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+struct Glyph
+{
+	uint32_t codepoint;
+	int horizontalBearingX;
+	int horizontalBearingY;
+	int horizontalAdvance;
+	int verticalBearingX;
+	int verticalBearingY;
+	int verticalAdvance;
+	int atlasX = 0;
+	int atlasY = 0;
+	int width;
+	int height;
+	std::vector<uint8_t> bitmap;
+};
+
+static bool ParseGlyphSet(const std::string& spec, std::vector<uint32_t>& codepoints)
+{
+	std::stringstream ss(spec);
+	std::string range;
+	while (std::getline(ss, range, ','))
+	{
+		try
+		{
+			auto dash = range.find('-', 1);
+			uint32_t first = (uint32_t)std::stoul(range.substr(0, dash), nullptr, 0);
+			uint32_t last = dash == std::string::npos ? first : (uint32_t)std::stoul(range.substr(dash + 1), nullptr, 0);
+			for (uint32_t c = first; c <= last; ++c)
+				codepoints.push_back(c);
+		}
+		catch (const std::exception&)
+		{
+			std::cerr << "Invalid glyph range " << range << std::endl;
+			return false;
+		}
+	}
+
+	std::sort(codepoints.begin(), codepoints.end());
+	codepoints.erase(std::unique(codepoints.begin(), codepoints.end()), codepoints.end());
+	return true;
+}
+
+// Shelf packs the glyphs, tallest first, into an atlas of the returned width and height
+static void Pack(std::vector<Glyph>& glyphs, int& atlas_width, int& atlas_height)
+{
+	const int padding = 1;
+
+	int area = 0;
+	int widest = 0;
+	for (auto& g : glyphs)
+	{
+		area += (g.width + padding) * (g.height + padding);
+		widest = std::max(widest, g.width + padding);
+	}
+
+	// Every glyph has to fit on a shelf on its own
+	atlas_width = 64;
+	while (atlas_width < widest || atlas_width * atlas_width < area)
+		atlas_width *= 2;
+
+	std::vector<Glyph*> order;
+	for (auto& g : glyphs)
+		order.push_back(&g);
+	std::stable_sort(order.begin(), order.end(), [](const Glyph* a, const Glyph* b) { return a->height > b->height; });
+
+	int x = 0;
+	int y = 0;
+	int shelf_height = 0;
+	for (auto g : order)
+	{
+		if (x + g->width > atlas_width)
+		{
+			x = 0;
+			y += shelf_height + padding;
+			shelf_height = 0;
+		}
+
+		g->atlasX = x;
+		g->atlasY = y;
+		x += g->width + padding;
+		shelf_height = std::max(shelf_height, g->height);
+	}
+
+	// At least one row, so a set of only empty glyphs (e.g. space) still emits an atlas
+	atlas_height = std::max(1, y + shelf_height);
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 5)
+	{
+		std::cerr << "Usage: olcFontEmbed <font> <size> <name> <output.h> [glyphs]" << std::endl;
+		return 1;
+	}
+
+	std::string font_path = argv[1];
+	int font_size = std::atoi(argv[2]);
+	std::string name = argv[3];
+	std::string output_path = argv[4];
+
+	std::vector<uint32_t> codepoints;
+	if (!ParseGlyphSet(argc > 5 ? argv[5] : "32-126", codepoints))
+		return 1;
+
+	FT_Library library;
+	FT_Face face;
+	if (FT_Init_FreeType(&library))
+	{
+		std::cerr << "Could not initialize library" << std::endl;
+		return 1;
+	}
+
+	if (FT_New_Face(library, font_path.c_str(), 0, &face))
+	{
+		std::cerr << "Could not load font " << font_path << std::endl;
+		return 1;
+	}
+
+	if (FT_Set_Char_Size(face, 0, font_size * 64, 0, 0))
+	{
+		std::cerr << "Could not set char size" << std::endl;
+		return 1;
+	}
+
+	std::vector<Glyph> glyphs;
+	for (auto c : codepoints)
+	{
+		auto index = FT_Get_Char_Index(face, c);
+		if (index == 0 || FT_Load_Glyph(face, index, FT_LOAD_DEFAULT) || FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL))
+		{
+			std::cerr << "Skipping missing glyph " << c << std::endl;
+			continue;
+		}
+
+		auto& metrics = face->glyph->metrics;
+		auto& bitmap = face->glyph->bitmap;
+
+		Glyph g;
+		g.codepoint = c;
+		g.horizontalBearingX = metrics.horiBearingX / 64;
+		g.horizontalBearingY = metrics.horiBearingY / 64;
+		g.horizontalAdvance = metrics.horiAdvance / 64;
+		g.verticalBearingX = metrics.vertBearingX / 64;
+		g.verticalBearingY = metrics.vertBearingY / 64;
+		g.verticalAdvance = metrics.vertAdvance / 64;
+		g.width = bitmap.width;
+		g.height = bitmap.rows;
+
+		g.bitmap.resize(g.width * g.height);
+		for (int row = 0; row < g.height; ++row)
+			std::copy(bitmap.buffer + row * bitmap.pitch, bitmap.buffer + row * bitmap.pitch + g.width, g.bitmap.begin() + row * g.width);
+
+		glyphs.push_back(std::move(g));
+	}
+
+	int line_height = (int)(face->size->metrics.height / 64);
+
+	FT_Done_Face(face);
+	FT_Done_FreeType(library);
+
+	if (glyphs.empty())
+	{
+		std::cerr << "None of the requested glyphs are in " << font_path << std::endl;
+		return 1;
+	}
+
+	int atlas_width = 0;
+	int atlas_height = 0;
+	Pack(glyphs, atlas_width, atlas_height);
+
+	std::vector<uint8_t> atlas(atlas_width * atlas_height, 0);
+	for (auto& g : glyphs)
+		for (int row = 0; row < g.height; ++row)
+			std::copy(g.bitmap.begin() + row * g.width, g.bitmap.begin() + (row + 1) * g.width, atlas.begin() + (g.atlasY + row) * atlas_width + g.atlasX);
+
+	std::vector<int> ascii(128, -1);
+	for (size_t i = 0; i < glyphs.size(); ++i)
+		if (glyphs[i].codepoint < 128)
+			ascii[glyphs[i].codepoint] = (int)i;
+
+	std::ofstream out(output_path);
+	if (!out)
+	{
+		std::cerr << "Could not open " << output_path << std::endl;
+		return 1;
+	}
+
+	auto filename = font_path.substr(font_path.find_last_of("/\\") + 1);
+
+	out << "// Generated by olcFontEmbed from " << filename << " at size " << font_size << ", do not edit\n\n";
+	out << "#pragma once\n\n";
+	out << "#include \"olcPGEX_Font.h\"\n\n";
+	out << "namespace olc::embedded\n{\n";
+	out << "\tnamespace " << name << "_data\n\t{\n";
+
+	out << "\t\tinline constexpr olc::EmbeddedGlyph glyphs[] = {\n";
+	for (auto& g : glyphs)
+	{
+		out << "\t\t\t{ " << g.codepoint << ", "
+			<< g.horizontalBearingX << ", " << g.horizontalBearingY << ", " << g.horizontalAdvance << ", "
+			<< g.verticalBearingX << ", " << g.verticalBearingY << ", " << g.verticalAdvance << ", "
+			<< g.atlasX << ", " << g.atlasY << ", " << g.width << ", " << g.height << " },\n";
+	}
+	out << "\t\t};\n\n";
+
+	out << "\t\tinline constexpr int16_t ascii[128] = {";
+	for (int i = 0; i < 128; ++i)
+		out << (i % 16 == 0 ? "\n\t\t\t" : " ") << ascii[i] << ",";
+	out << "\n\t\t};\n\n";
+
+	out << "\t\tinline constexpr uint8_t atlas[] = {";
+	for (size_t i = 0; i < atlas.size(); ++i)
+		out << (i % 32 == 0 ? "\n\t\t\t" : "") << (int)atlas[i] << ",";
+	out << "\n\t\t};\n\t}\n\n";
+
+	out << "\tinline constexpr olc::EmbeddedFontData " << name << " = {\n";
+	out << "\t\t" << atlas_width << ", " << atlas_height << ", " << line_height << ", " << glyphs.size() << ",\n";
+	out << "\t\t" << name << "_data::glyphs, " << name << "_data::ascii, " << name << "_data::atlas\n";
+	out << "\t};\n}\n";
+
+	return 0;
+}